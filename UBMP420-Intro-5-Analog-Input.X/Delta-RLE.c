@@ -0,0 +1,140 @@
+/*==============================================================================
+ Library:   Delta-RLE
+ Date:      October 19, 2026
+
+ Streaming delta and run-length encoder for 8-bit ADC samples. Slowly changing
+ inputs, such as the on-die temperature indicator, mostly produce repeated
+ samples or changes of one or two counts. Repeated samples are counted and sent
+ as a single Run byte, pairs of small changes are packed into a single byte,
+ and only large jumps cost the full two-byte Literal. See Delta-RLE.h for the
+ encoded byte format.
+
+ Each call to encode_sample() does a fixed amount of work using only simple
+ comparisons, shifts, and logical operations (no loops), so its execution time
+ is bounded and it can be called from a tight sampling loop.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+// Only compile the library if stream mode is selected in the project
+#ifdef STREAM_MODE
+
+#include    "Delta-RLE.h"       // Include delta-RLE encoder constants
+
+// Encoder output buffer and state variables
+unsigned char encOut[3];        // Encoded bytes ready to be written
+unsigned char encCount;         // Number of bytes in encOut
+unsigned char encPrev;          // Previous sample value
+unsigned char encRun;           // Number of held repeated samples
+unsigned char encHeld;          // Held zig-zag delta waiting for a pair
+bool encHolding;                // True if encHeld contains a delta
+unsigned char encKey;           // Samples until the next Literal keyframe
+
+// Restart the stream so that the next sample is sent as a Literal
+void encode_reset(void)
+{
+    encRun = 0;
+    encHolding = false;
+    encKey = 0;
+}
+
+// Encode one sample into encOut and return the number of encoded bytes
+unsigned char encode_sample(unsigned char sample)
+{
+    unsigned char delta;
+    unsigned char zig;
+
+    // Start each stream with a Literal so the decoder has a reference value,
+    // and repeat it as a keyframe so that a receiver can resync. Any held run
+    // or delta is written first to keep the samples in order.
+    if(encKey == 0)
+    {
+        encode_flush();
+        encOut[encCount++] = RLE_LITERAL;
+        encOut[encCount++] = sample;
+        encPrev = sample;
+        encKey = RLE_KEYFRAME - 1;
+        return (encCount);
+    }
+    encKey --;
+    encCount = 0;
+
+    delta = sample - encPrev;   // 8-bit wrap-around difference
+    encPrev = sample;
+
+    // Count repeated samples, sending a Run byte only when the run is full
+    if(delta == 0 && !encHolding)
+    {
+        encRun ++;
+        if(encRun == RLE_RUN_MAX)
+        {
+            encOut[encCount++] = RLE_RUN | (RLE_RUN_MAX - 1);
+            encRun = 0;
+        }
+        return (encCount);
+    }
+
+    // A changed sample ends the current run
+    if(encRun != 0)
+    {
+        encOut[encCount++] = RLE_RUN | (encRun - 1);
+        encRun = 0;
+    }
+
+    // Zig-zag code the delta: 0, -1, +1, -2, +2... become 0, 1, 2, 3, 4...
+    zig = delta << 1;
+    if(delta & 0b10000000)      // Invert the shifted value of negative deltas
+    {
+        zig = ~zig;
+    }
+
+    // Pack a held delta with this one if both fit in 3 bits
+    if(encHolding)
+    {
+        encHolding = false;
+        if(zig < 8)
+        {
+            encOut[encCount++] = RLE_PAIR | (encHeld << 3) | zig;
+            return (encCount);
+        }
+        encOut[encCount++] = RLE_DELTA | encHeld;
+    }
+
+    // Hold small deltas for pairing, or send as a Delta or Literal
+    if(zig < 8)
+    {
+        encHeld = zig;
+        encHolding = true;
+    }
+    else if(zig < 64)
+    {
+        encOut[encCount++] = RLE_DELTA | zig;
+    }
+    else
+    {
+        encOut[encCount++] = RLE_LITERAL;
+        encOut[encCount++] = sample;
+    }
+    return (encCount);
+}
+
+// Write any held run or delta into encOut and return the number of bytes
+unsigned char encode_flush(void)
+{
+    encCount = 0;
+    if(encRun != 0)
+    {
+        encOut[encCount++] = RLE_RUN | (encRun - 1);
+        encRun = 0;
+    }
+    else if(encHolding)
+    {
+        encOut[encCount++] = RLE_DELTA | encHeld;
+        encHolding = false;
+    }
+    return (encCount);
+}
+
+#endif
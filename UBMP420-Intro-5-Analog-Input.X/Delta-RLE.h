@@ -0,0 +1,77 @@
+/*==============================================================================
+ File:  Delta-RLE.h
+ Date:  October 19, 2026
+
+ UBMP4 delta and run-length sample encoder constants and function prototypes
+
+ Each encoded sample is stored as the zig-zag coded difference from the
+ previous sample (zig-zag coding maps deltas of 0, -1, +1, -2, +2... to codes
+ 0, 1, 2, 3, 4... so that small changes in either direction become small
+ numbers). Every encoded byte starts with a 2-bit token type:
+
+ 00nnnnnn           Run: the previous sample repeats n+1 times (1-64)
+ 01aaabbb           Pair: two samples with 3-bit zig-zag deltas a, then b
+                    (each delta in the range -4 to +3)
+ 10zzzzzz           Delta: one sample with a 6-bit zig-zag delta z
+                    (delta in the range -32 to +31)
+ 11000000 ssssssss  Literal: the next byte is the raw sample value s
+
+ The first sample of every stream (and after each encode_reset()) is sent as a
+ Literal, and every RLE_KEYFRAME samples after that another Literal keyframe
+ is sent, after any held Run or Delta. To decode, start from the Literal
+ sample value, add each decoded delta to the previous sample (ignoring any
+ carry out of 8 bits), and convert zig-zag codes back to deltas using:
+ delta = (z is odd) ? ~(z >> 1) : (z >> 1).
+
+ The Literal marker 11000000 is the only token byte starting with 11, so a
+ receiver that starts listening part way through the stream, or that loses a
+ byte, can resync by waiting for the next 11000000 byte. (A Literal's sample
+ byte can also be 11000000, so a receiver may sync on the wrong byte, but it
+ will be back in step after the following keyframe.)
+==============================================================================*/
+
+// Encoded token type definitions
+#define RLE_RUN         0b00000000  // Run of repeated samples
+#define RLE_PAIR        0b01000000  // Two packed 3-bit deltas
+#define RLE_DELTA       0b10000000  // One 6-bit delta
+#define RLE_LITERAL     0b11000000  // Raw sample byte follows
+
+// Samples between Literal keyframes (1-256). At the 100ms STREAM_MODE sample
+// period a receiver is in step within 6.4s of connecting to H1.
+#define RLE_KEYFRAME    64
+
+// Longest run of repeated samples held before a Run byte is sent (1-64). At
+// the 100ms STREAM_MODE sample period a steady input is sent every 1.6s.
+#define RLE_RUN_MAX     16
+
+// Encoder output buffer - a single sample never produces more than 3 bytes
+extern unsigned char encOut[3];
+
+/**
+ * Function: void encode_reset(void)
+ *
+ * Restart the encoded stream. The next sample will be sent as a Literal.
+ */
+void encode_reset(void);
+
+/**
+ * Function: unsigned char encode_sample(unsigned char sample)
+ *
+ * Encode one sample into the encOut buffer and return the number of encoded
+ * bytes ready to be written (0 to 3). Repeated samples (up to RLE_RUN_MAX of
+ * them) and the first of each pair of small deltas are held by the encoder
+ * until a later sample completes them, the next keyframe is sent, or
+ * encode_flush() is called.
+ *
+ * Example usage: count = encode_sample(rawADC);
+ */
+unsigned char encode_sample(unsigned char);
+
+/**
+ * Function: unsigned char encode_flush(void)
+ *
+ * Write any held run or delta into the encOut buffer and return the number of
+ * encoded bytes ready to be written (0 or 1). Call before stopping or resetting
+ * so that no held samples are lost.
+ */
+unsigned char encode_flush(void);
@@ -0,0 +1,249 @@
+/*==============================================================================
+ Library:   Flash-Log
+ Date:      October 19, 2026
+
+ Flash sample logging functions. Samples are collected in one of two RAM row
+ buffers, and each full buffer is written to flash as a complete row record
+ while new samples fill the other buffer. Writing whole rows means each flash
+ erase and write stall (a few milliseconds, during which the processor stops)
+ happens only once per LOG_ROW_DATA samples, and can be done from log_update()
+ between samples instead of inside the sampling code.
+
+ Records are written to the HEF rows in rotation, always replacing the oldest
+ record, so every row is erased equally often and the log keeps the most
+ recent LOG_ROWS * LOG_ROW_DATA logged samples. Only one of every LOG_INTERVAL
+ samples is logged, to keep the erase rate within the HEF endurance budget
+ (see Flash-Log.h). Each record is written in two steps:
+ the sequence number, samples, and CRC first, and then the commit marker. A
+ power loss during the first write leaves the commit marker erased, and a
+ power loss during an erase changes the record's CRC, so a damaged row is
+ rejected by log_config() and never becomes part of the log.
+
+ All flash access is done through the Flash-Memory functions, so this library
+ can be tested on a host computer using an emulated flash memory.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+// Only compile the library if flash log mode is selected in the project
+#ifdef LOG_MODE
+
+#include    "UBMP420.h"         // Include UBMP4 constants and functions
+#include    "Simple-Serial.h"   // Include simple serial functions
+#include    "Flash-Memory.h"    // Include flash memory functions
+#include    "Flash-Log.h"       // Include flash log constants
+
+// RAM row buffers and log state variables
+unsigned char logBuffer[2][LOG_ROW_SIZE];   // Row records being filled/written
+unsigned char logActive;        // Row buffer currently being filled (0 or 1)
+unsigned char logCount;         // Samples in the active row buffer
+unsigned int logSkip;           // Samples to skip before the next logged one
+bool logPending;                // True if the other row buffer needs writing
+unsigned char logRow;           // Next flash row to write (0 to LOG_ROWS - 1)
+unsigned char logSeq;           // Next record sequence number
+unsigned char logRecords;       // Valid records in flash (0 to LOG_ROWS)
+
+// Add one byte to a CRC-8 (polynomial x^8 + x^2 + x + 1) and return the result
+unsigned char log_crc(unsigned char crc, unsigned char data)
+{
+    crc = crc ^ data;
+    for(unsigned char bits = 8; bits != 0; bits--)
+    {
+        if(crc & 0b10000000)
+        {
+            crc = (unsigned char)(crc << 1) ^ 0b00000111;
+        }
+        else
+        {
+            crc = crc << 1;
+        }
+    }
+    return (crc);
+}
+
+// Return true if the log row contains a complete record with a correct CRC
+bool log_row_valid(unsigned char row)
+{
+    unsigned int address = LOG_START + row * LOG_ROW_SIZE;
+    unsigned char crc = 0xFF;   // Non-zero start value rejects all-0 rows
+
+    if(flash_read(address + LOG_ROW_SIZE - 1) != LOG_COMMIT)
+    {
+        return (false);
+    }
+    if(flash_read(address) == 0xFF)     // Erased rows have no sequence number
+    {
+        return (false);
+    }
+    for(unsigned char i = LOG_ROW_SIZE - 2; i != 0; i--)
+    {
+        crc = log_crc(crc, flash_read(address));
+        address ++;
+    }
+    return (crc == flash_read(address));
+}
+
+// Find the newest record and prepare to log into the row following it
+void log_config(void)
+{
+    bool valid[LOG_ROWS];
+    unsigned char seq[LOG_ROWS];
+    unsigned char length;
+    unsigned char row;
+    unsigned char prev;
+
+    for(row = 0; row != LOG_ROWS; row++)
+    {
+        valid[row] = log_row_valid(row);
+        seq[row] = flash_read(LOG_START + row * LOG_ROW_SIZE);
+    }
+
+    // Find the longest chain of records with consecutive sequence numbers in
+    // consecutive rows. Its last record is the newest, and valid rows outside
+    // the chain (such as a damaged row that passed its checks) are ignored.
+    logRecords = 0;
+    logRow = 0;                 // Start at the first row if the log is empty
+    logSeq = 0;
+    for(unsigned char newest = 0; newest != LOG_ROWS; newest++)
+    {
+        if(!valid[newest])
+        {
+            continue;
+        }
+        length = 1;
+        row = newest;
+        while(length != LOG_ROWS)
+        {
+            prev = (row - 1) & (LOG_ROWS - 1);
+            if(!valid[prev] || seq[prev] != ((seq[row] == 0) ? 254 : seq[row] - 1))
+            {
+                break;
+            }
+            length ++;
+            row = prev;
+        }
+        if(length > logRecords)
+        {
+            logRecords = length;
+            logRow = (newest + 1) & (LOG_ROWS - 1);
+            logSeq = (seq[newest] == 254) ? 0 : seq[newest] + 1;
+        }
+    }
+
+    logActive = 0;
+    logCount = 0;
+    logSkip = 0;
+    logPending = false;
+}
+
+// Add one of every LOG_INTERVAL samples to the active row buffer, switching
+// buffers when it is full
+void log_sample(unsigned char sample)
+{
+    // Limit the flash erase rate by only logging one sample per interval
+    if(logSkip != 0)
+    {
+        logSkip --;
+        return;
+    }
+    logSkip = LOG_INTERVAL - 1;
+
+    logCount ++;
+    logBuffer[logActive][logCount] = sample;    // Samples start after word 0
+    if(logCount == LOG_ROW_DATA)
+    {
+        if(logPending)          // Write the other buffer now if still waiting
+        {
+            log_update();
+        }
+        logActive = logActive ^ 1;
+        logCount = 0;
+        logPending = true;
+    }
+}
+
+// Write the waiting row buffer into the next flash row
+void log_update(void)
+{
+    unsigned char *record;
+    unsigned int address;
+    unsigned char crc = 0xFF;
+
+    if(!logPending)
+    {
+        return;
+    }
+
+    // Add the sequence number and CRC, and leave the commit marker erased
+    record = logBuffer[logActive ^ 1];
+    record[0] = logSeq;
+    for(unsigned char i = 0; i != LOG_ROW_SIZE - 2; i++)
+    {
+        crc = log_crc(crc, record[i]);
+    }
+    record[LOG_ROW_SIZE - 2] = crc;
+    record[LOG_ROW_SIZE - 1] = 0xFF;
+
+    // The oldest record is lost as soon as its row starts being erased
+    if(logRecords == LOG_ROWS)
+    {
+        logRecords --;
+    }
+
+    // Write the record, then commit it once all of its data is in flash
+    address = LOG_START + logRow * LOG_ROW_SIZE;
+    flash_erase_row(address);
+    flash_write_row(address, record);
+    flash_write_word(address + LOG_ROW_SIZE - 1, LOG_COMMIT);
+
+    logRecords ++;
+    logRow = (logRow + 1) & (LOG_ROWS - 1);
+    logSeq = (logSeq == 254) ? 0 : logSeq + 1;
+    logPending = false;
+}
+
+// Write the sync byte, sample count, and all logged samples to H1
+void log_dump(void)
+{
+    unsigned char count = logRecords * LOG_ROW_DATA + logCount;
+    unsigned char row;
+    unsigned int address;
+
+    if(logPending)
+    {
+        count = count + LOG_ROW_DATA;
+    }
+
+    H1_serial_write(LOG_SYNC);
+    H1_serial_write(count);
+
+    // Write the chain of flash records, starting with the oldest
+    row = (logRow - logRecords) & (LOG_ROWS - 1);
+    for(unsigned char records = logRecords; records != 0; records--)
+    {
+        address = LOG_START + row * LOG_ROW_SIZE + 1;
+        for(unsigned char i = LOG_ROW_DATA; i != 0; i--)
+        {
+            H1_serial_write(flash_read(address));
+            address ++;
+        }
+        row = (row + 1) & (LOG_ROWS - 1);
+    }
+
+    // Follow the flash records with any samples not yet written to flash
+    if(logPending)
+    {
+        for(unsigned char i = 1; i <= LOG_ROW_DATA; i++)
+        {
+            H1_serial_write(logBuffer[logActive ^ 1][i]);
+        }
+    }
+    for(unsigned char i = 1; i <= logCount; i++)
+    {
+        H1_serial_write(logBuffer[logActive][i]);
+    }
+}
+
+#endif
@@ -0,0 +1,81 @@
+/*==============================================================================
+ File:  Flash-Log.h
+ Date:  October 19, 2026
+
+ UBMP4 flash sample logger constants and function prototypes
+
+ Constants and function prototypes for logging ADC samples into the
+ PIC16F1459 high-endurance flash (HEF) rows at the top of program memory.
+ The HEF rows must be excluded from the linker ROM range (default,-0-7FF,
+ -1F80-1FFF) so that program code is never placed in them. Include
+ Flash-Memory.h before this file.
+
+ Each 32-word flash row holds one log record. Only the low byte of each word
+ is used, since only the low byte of HEF words has high endurance:
+
+ Word 0             Sequence number (0-254, 0xFF if the row is erased)
+ Words 1-29         Logged samples, oldest first
+ Word 30            CRC-8 of words 0-29
+ Word 31            Commit marker (LOG_COMMIT), written after words 0-30
+
+ A record is only valid if its commit marker and CRC are both correct, and
+ only records with consecutive sequence numbers in consecutive rows (ending
+ at the newest record) are part of the log.
+
+ Flash endurance:
+ HEF rows are rated for 100,000 erase/write cycles. Records rotate through
+ LOG_ROWS rows, so each row is erased once every LOG_ROWS * LOG_ROW_DATA (116)
+ logged samples, and log_sample() logs only one of every LOG_INTERVAL samples
+ it is given. At the 100ms LOG_MODE loop period, a LOG_INTERVAL of 600 logs
+ one sample per minute, erases each row about every 1.9 hours, and lasts for
+ about 22 years of continuous logging (the log holds the last 116 minutes).
+ Logging every sample (a LOG_INTERVAL of 1) would erase each row every 11.6s
+ and wear out the HEF rows in about 13 days.
+==============================================================================*/
+
+// Flash log memory definitions
+#define LOG_START       0x1F80      // First HEF row address
+#define LOG_ROWS        4           // Number of HEF rows used for the log
+#define LOG_ROW_SIZE    FLASH_ROW_SIZE  // Words (record bytes) per flash row
+#define LOG_ROW_DATA    29          // Samples per flash row record
+#define LOG_COMMIT      0x00        // Commit marker value of a complete record
+#define LOG_INTERVAL    600         // Samples per logged sample (1-65535)
+
+// Log dump sync byte written to H1 before the logged samples
+#define LOG_SYNC        0x5A
+
+/**
+ * Function: void log_config(void)
+ *
+ * Find the newest valid record and the chain of records before it, and set
+ * up to continue logging into the row following the newest record. Rows left
+ * incomplete by a power loss are not part of the chain, and are skipped.
+ */
+void log_config(void);
+
+/**
+ * Function: void log_sample(unsigned char sample)
+ *
+ * Add the first of every LOG_INTERVAL samples (starting with the first sample
+ * after log_config()) to the RAM row buffer. A full buffer is handed over to
+ * log_update() for writing while new samples fill the second buffer.
+ *
+ * Example usage: log_sample(rawADC);
+ */
+void log_sample(unsigned char);
+
+/**
+ * Function: void log_update(void)
+ *
+ * Erase and write a full row buffer into the next log row, if one is waiting.
+ * Call between samples, at least once for every LOG_ROW_DATA samples.
+ */
+void log_update(void);
+
+/**
+ * Function: void log_dump(void)
+ *
+ * Write the log to H1: the LOG_SYNC byte, a count of logged samples, and then
+ * the logged samples from oldest to newest, including unwritten RAM samples.
+ */
+void log_dump(void);
@@ -0,0 +1,100 @@
+/*==============================================================================
+ Library:   Flash-Memory
+ Date:      October 19, 2026
+
+ PIC16F1459 flash program memory access functions. Flash is read one word at a
+ time, erased one 32-word row at a time, and written by loading the row's
+ write latches and then starting a write of the whole row. Latches that are not
+ loaded hold 0x3FFF (erased), so writing a single word leaves the other words
+ in its row unchanged. Only the low byte of each word is used, since only the
+ low byte of the high-endurance flash (HEF) words has high endurance.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+// Only compile the library if flash log mode is selected in the project
+#ifdef LOG_MODE
+
+#include    "Flash-Memory.h"    // Include flash memory constants
+
+// Read the low byte of the flash program memory word at address
+unsigned char flash_read(unsigned int address)
+{
+    PMADRH = (unsigned char)(address >> 8);
+    PMADRL = (unsigned char)address;
+    PMCON1bits.CFGS = 0;        // Select program memory, not configuration
+    PMCON1bits.RD = 1;          // Start the read
+    NOP();                      // Processor ignores the two instructions
+    NOP();                      // following a program memory read
+    return (PMDATL);
+}
+
+// Send the flash unlock sequence to start an erase, write, or latch load
+void flash_unlock(void)
+{
+    bool gie = GIE;
+
+    GIE = 0;                    // The unlock sequence must not be interrupted
+    PMCON2 = 0x55;
+    PMCON2 = 0xAA;
+    PMCON1bits.WR = 1;
+    NOP();                      // Processor stalls here until the operation is
+    NOP();                      // complete
+    GIE = gie;
+}
+
+// Erase the flash row starting at address
+void flash_erase_row(unsigned int address)
+{
+    PMADRH = (unsigned char)(address >> 8);
+    PMADRL = (unsigned char)address;
+    PMCON1bits.CFGS = 0;
+    PMCON1bits.FREE = 1;        // Select an erase operation
+    PMCON1bits.WREN = 1;        // Enable flash writes
+    flash_unlock();
+    PMCON1bits.WREN = 0;
+}
+
+// Write FLASH_ROW_SIZE bytes of data into the low bytes of the row at address
+void flash_write_row(unsigned int address, unsigned char *data)
+{
+    PMADRH = (unsigned char)(address >> 8);
+    PMADRL = (unsigned char)address;
+    PMCON1bits.CFGS = 0;
+    PMCON1bits.FREE = 0;        // Select a write operation
+    PMCON1bits.WREN = 1;
+    PMCON1bits.LWLO = 1;        // Load the write latches only
+
+    for(unsigned char i = FLASH_ROW_SIZE; i != 0; i--)
+    {
+        PMDATH = 0x3F;          // Leave the upper (non-HEF) bits erased
+        PMDATL = *data;
+        data ++;
+        if(i == 1)
+        {
+            PMCON1bits.LWLO = 0;    // Write all latches on the last word
+        }
+        flash_unlock();
+        PMADRL ++;
+    }
+    PMCON1bits.WREN = 0;
+}
+
+// Write data into the low byte of the single flash word at address
+void flash_write_word(unsigned int address, unsigned char data)
+{
+    PMADRH = (unsigned char)(address >> 8);
+    PMADRL = (unsigned char)address;
+    PMCON1bits.CFGS = 0;
+    PMCON1bits.FREE = 0;
+    PMCON1bits.WREN = 1;
+    PMCON1bits.LWLO = 0;        // Write the row with only this latch loaded
+    PMDATH = 0x3F;
+    PMDATL = data;
+    flash_unlock();
+    PMCON1bits.WREN = 0;
+}
+
+#endif
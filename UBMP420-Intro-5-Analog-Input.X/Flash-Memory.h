@@ -0,0 +1,45 @@
+/*==============================================================================
+ File:  Flash-Memory.h
+ Date:  October 19, 2026
+
+ UBMP4 (PIC16F1459) flash program memory access function prototypes
+
+ Function prototypes for reading, erasing, and writing the low byte of flash
+ program memory words. The Flash-Log library only accesses flash through these
+ functions, so a host build can replace Flash-Memory.c with an emulated flash.
+==============================================================================*/
+
+// Flash program memory definitions
+#define FLASH_ROW_SIZE  32          // Words in each erasable flash row
+
+/**
+ * Function: unsigned char flash_read(unsigned int address)
+ *
+ * Read the low byte of the flash program memory word at address.
+ */
+unsigned char flash_read(unsigned int);
+
+/**
+ * Function: void flash_erase_row(unsigned int address)
+ *
+ * Erase the flash row starting at address (setting all bits to 1). The
+ * processor stalls until the erase completes.
+ */
+void flash_erase_row(unsigned int);
+
+/**
+ * Function: void flash_write_row(unsigned int address, unsigned char *data)
+ *
+ * Write FLASH_ROW_SIZE bytes from data into the low bytes of the flash row
+ * starting at address. Writing can only clear bits, so the row must be erased
+ * first. The processor stalls until the write completes.
+ */
+void flash_write_row(unsigned int, unsigned char *);
+
+/**
+ * Function: void flash_write_word(unsigned int address, unsigned char data)
+ *
+ * Write data into the low byte of the single flash word at address, leaving
+ * the rest of its row unchanged. Writing can only clear bits.
+ */
+void flash_write_word(unsigned int, unsigned char);
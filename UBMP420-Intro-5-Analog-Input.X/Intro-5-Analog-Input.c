@@ -19,15 +19,41 @@
 #include    "UBMP420.h"         // Include UBMP4.2 constants and functions
 #include    "Simple-Serial.h"   // Include simple serial functions
 
-// TODO Set linker ROM ranges to 'default,-0-7FF' under "Memory model" pull-down.
+// Sample modes are selected by the project's preprocessor macros (see below),
+// and only one of them can be used at a time
+#if defined(CAPTURE_MODE) + defined(STREAM_MODE) + defined(LOG_MODE) > 1
+#error "Define only one of CAPTURE_MODE, STREAM_MODE, or LOG_MODE"
+#endif
+
+#ifdef CAPTURE_MODE
+#include    "Trigger-Capture.h" // Include triggered capture functions
+#endif
+#ifdef STREAM_MODE
+#include    "Delta-RLE.h"       // Include delta-RLE encoder functions
+#endif
+#ifdef LOG_MODE
+#include    "Flash-Memory.h"    // Include flash memory functions
+#include    "Flash-Log.h"       // Include flash sample logging functions
+#endif
+
+// TODO Set linker ROM ranges to 'default,-0-7FF,-1F80-1FFF' under "Memory model"
+// pull-down (reserves the high-endurance flash rows used by Flash-Log).
 // TODO Set linker code offset to '800' under "Additional options" pull-down.
 
+// TODO Optionally add one sample mode (CAPTURE_MODE, STREAM_MODE, or LOG_MODE)
+// to "Define macros" under the compiler "Preprocessing and messages" pull-down,
+// or build with 'make MP_EXTRA_CC_PRE=-DLOG_MODE' after 'make clean'. With no
+// sample mode defined, the program displays ADC results on the LEDs.
+
 // ASCII character code definitions
 #define LF      10              // ASCII line feed character code
 #define CR      13              // ASCII carriage return character code
 
 // Program variable definitions
 unsigned char rawADC;           // Raw ADC conversion result
+#ifdef STREAM_MODE
+unsigned char encoded;          // Number of encoded bytes to write
+#endif
 
 // Decimal digit variables used by binary to decimal conversion function
 unsigned char dec0;             // Decimal digit 0 - ones digit
@@ -81,8 +107,53 @@ int main(void)
     // Select Q1 phototransistor as ADC input (can be selected if Q1 is installed)
     // ADC_select_channel(ANQ1);
     
+#ifdef CAPTURE_MODE
+    // Capture 16 samples before and 48 samples after each rising edge through
+    // the middle of the ADC range, re-arming 4 counts below the trigger level
+    capture_config(TRIG_RISING, 128, 0, 4);
+#endif
+#ifdef STREAM_MODE
+    encode_reset();             // Start the encoded stream with a Literal
+#endif
+#ifdef LOG_MODE
+    log_config();               // Continue logging after the newest record
+#endif
+    
     while(1)
     {
+#ifdef CAPTURE_MODE
+        // Sample as fast as the ADC allows, writing one byte of any completed
+        // frame to H1 before each sample replaces the byte's buffer location
+        rawADC = ADC_read();
+        capture_write();
+        capture_sample(rawADC);
+#elif defined STREAM_MODE
+        // Encode each sample and write only the encoded bytes to H1
+        rawADC = ADC_read();
+        encoded = encode_sample(rawADC);
+        for(unsigned char i = 0; i != encoded; i++)
+        {
+            H1_serial_write(encOut[i]);
+        }
+        
+        __delay_ms(100);
+#elif defined LOG_MODE
+        // Log one sample every LOG_INTERVAL loops (one per minute), then write
+        // any full row to flash between samples
+        rawADC = ADC_read();
+        log_sample(rawADC);
+        log_update();
+        
+        // Dump the log to H1 when SW3 is pressed, and wait for its release
+        if(SW3 == 0)
+        {
+            log_dump();
+            while(SW3 == 0)
+                ;
+        }
+        
+        __delay_ms(100);
+#else
         // Read selected ADC channel and display the analog result on the LEDs
         rawADC = ADC_read();
         LATC = rawADC;
@@ -90,10 +161,19 @@ int main(void)
         // Add serial write code from the program analysis activities here:
         
         __delay_ms(100);
+#endif
         
         // Activate bootloader if SW1 is pressed.
         if(SW1 == 0)
         {
+#ifdef STREAM_MODE
+            // Write any held encoder samples before they are lost
+            encoded = encode_flush();
+            for(unsigned char i = 0; i != encoded; i++)
+            {
+                H1_serial_write(encOut[i]);
+            }
+#endif
             RESET();
         }
     }
@@ -0,0 +1,208 @@
+/*==============================================================================
+ Library:   Trigger-Capture
+ Date:      October 19, 2026
+
+ Triggered ADC capture functions. Every ADC sample is written into a circular
+ history buffer, and the trigger condition is tested on the same sample as it
+ is stored. When the trigger fires, CAPTURE_POST more samples (including the
+ trigger sample) are stored, leaving CAPTURE_PRE samples of pre-trigger history
+ in front of the event. Only completed frames are written to H1, so idle
+ periods between events use none of the serial output time.
+
+ Completed frames are written one byte per sample, oldest first, so each new
+ sample can be stored in the buffer location of the byte just written. The
+ samples stored while the frame is written are spaced by the serial write
+ time, so they are discarded when the frame is finished, and the trigger can
+ fire again once CAPTURE_PRE new samples have been stored at the full ADC rate.
+ This keeps every frame sampled at the same rate.
+
+ All trigger modes use hysteresis: after firing, they only re-arm once the
+ input has moved back past the trigger level by the hysteresis amount,
+ preventing noise or a steady input from causing repeated triggers.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+// Only compile the library if triggered capture mode is selected in the project
+#ifdef CAPTURE_MODE
+
+#include    "UBMP420.h"         // Include UBMP4 constants and functions
+#include    "Simple-Serial.h"   // Include simple serial functions
+#include    "Trigger-Capture.h" // Include trigger capture constants
+
+// Capture history buffer and state variables
+unsigned char captureBuffer[CAPTURE_SIZE];  // Circular sample history buffer
+unsigned char captureIndex;     // Buffer position for the next sample
+unsigned char captureFill;      // Count of pre-trigger samples in the buffer
+unsigned char captureCount;     // Post-trigger samples or frame bytes left
+unsigned char captureState;     // Current capture state (CAPTURE_ARMED, etc.)
+
+// Trigger settings
+unsigned char trigMode;         // Trigger mode (TRIG_LEVEL, TRIG_RISING, etc.)
+unsigned char trigLevel;        // Trigger level (window low limit)
+unsigned char trigHigh;         // Window high limit
+unsigned char trigArmLow;       // Input level needed to re-arm (low side)
+unsigned char trigArmHigh;      // Input level needed to re-arm (high side)
+bool trigArmed;                 // Trigger armed flag
+bool trigRearm;                 // False if the re-arm range can't be reached
+
+// Set trigger mode, level, window high limit, and hysteresis, and arm trigger
+void capture_config(unsigned char mode, unsigned char level, unsigned char high, unsigned char hyst)
+{
+    trigMode = mode;
+    trigLevel = level;
+    trigHigh = high;
+
+    // Pre-calculate re-arm levels so that capture_sample() only has to compare.
+    // If the re-arm range is outside 0-255, the trigger stays armed instead.
+    trigRearm = true;
+    if(mode == TRIG_WINDOW)
+    {
+        // Re-arm once the input is back inside the window by hyst counts
+        if(level + hyst <= high - hyst)
+        {
+            trigArmLow = level + hyst;
+            trigArmHigh = high - hyst;
+        }
+        else
+        {
+            trigRearm = false;
+        }
+    }
+    else if(mode == TRIG_FALLING)
+    {
+        // Re-arm once the input is more than hyst counts above the level
+        if(level + hyst < 255)
+        {
+            trigArmHigh = level + hyst;
+        }
+        else
+        {
+            trigRearm = false;
+        }
+    }
+    else
+    {
+        // Re-arm once the input is more than hyst counts below the level
+        if(level > hyst)
+        {
+            trigArmLow = level - hyst;
+        }
+        else
+        {
+            trigRearm = false;
+        }
+    }
+
+    // Level triggers start armed, edge and window triggers must see a re-arm
+    trigArmed = (mode == TRIG_LEVEL || !trigRearm);
+    captureIndex = 0;
+    captureFill = 0;
+    captureState = CAPTURE_ARMED;
+}
+
+// Store one ADC sample, test the trigger, and return the capture state
+unsigned char capture_sample(unsigned char sample)
+{
+    bool fire = false;
+    bool ready;
+
+    // While sending, this replaces the frame byte that was just written
+    captureBuffer[captureIndex] = sample;
+    captureIndex = (captureIndex + 1) & (CAPTURE_SIZE - 1);
+
+    // Count down post-trigger samples until the frame is complete
+    if(captureState == CAPTURE_POSTING)
+    {
+        captureCount --;
+        if(captureCount == 0)
+        {
+            captureCount = CAPTURE_SIZE;    // Frame bytes left to write
+            captureState = CAPTURE_SENDING;
+        }
+        return (captureState);
+    }
+
+    // A trigger can only start a frame once a full pre-trigger history exists
+    ready = (captureState == CAPTURE_ARMED && captureFill == CAPTURE_PRE);
+    if(captureFill < CAPTURE_PRE)
+    {
+        captureFill ++;
+    }
+
+    // Test the trigger condition, or the re-arm condition if not armed
+    switch(trigMode)
+    {
+        case TRIG_LEVEL:
+        case TRIG_RISING:
+            if(trigArmed)
+            {
+                fire = (sample >= trigLevel);
+            }
+            else if(sample < trigArmLow)
+            {
+                trigArmed = true;
+            }
+            break;
+        case TRIG_FALLING:
+            if(trigArmed)
+            {
+                fire = (sample <= trigLevel);
+            }
+            else if(sample > trigArmHigh)
+            {
+                trigArmed = true;
+            }
+            break;
+        case TRIG_WINDOW:
+            if(trigArmed)
+            {
+                fire = (sample < trigLevel || sample > trigHigh);
+            }
+            else if(sample >= trigArmLow && sample <= trigArmHigh)
+            {
+                trigArmed = true;
+            }
+            break;
+    }
+
+    if(fire && ready)
+    {
+        trigArmed = !trigRearm;
+        captureCount = CAPTURE_POST - 1;    // Trigger sample is the first one
+        captureState = CAPTURE_POSTING;
+    }
+    else if(fire && captureState == CAPTURE_SENDING)
+    {
+        trigArmed = !trigRearm;     // Trigger is lost during the frame write
+    }
+    return (captureState);
+}
+
+// Write the next byte of the completed frame to H1, oldest sample first
+void capture_write(void)
+{
+    if(captureState != CAPTURE_SENDING)
+    {
+        return;
+    }
+
+    // Start each frame with the sync byte
+    if(captureCount == CAPTURE_SIZE)
+    {
+        H1_serial_write(CAPTURE_SYNC);
+    }
+
+    // The oldest unsent sample is at the next write position
+    H1_serial_write(captureBuffer[captureIndex]);
+    captureCount --;
+    if(captureCount == 0)
+    {
+        captureFill = 0;        // Discard the history stored while sending
+        captureState = CAPTURE_ARMED;
+    }
+}
+
+#endif
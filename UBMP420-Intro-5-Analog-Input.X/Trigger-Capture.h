@@ -0,0 +1,85 @@
+/*==============================================================================
+ File:  Trigger-Capture.h
+ Date:  October 19, 2026
+
+ UBMP4 triggered ADC capture constants and function prototypes
+
+ Constants and function prototypes for a level, edge, or window triggered
+ capture engine. ADC samples are continuously stored in a circular history
+ buffer so that the samples leading up to a trigger event can be sent along
+ with the samples following it, instead of streaming every sample over H1.
+
+ Trigger re-arming:
+ After firing, a trigger re-arms only once the input has moved back past the
+ trigger level by the hysteresis amount: below (level - hyst) for TRIG_LEVEL
+ and TRIG_RISING, above (level + hyst) for TRIG_FALLING, or inside the window
+ from (level + hyst) to (high - hyst) for TRIG_WINDOW. If that re-arm range is
+ outside 0-255 (or the window is too narrow to contain it) the trigger stays
+ armed, and fires again as soon as new history has been stored after the next
+ frame has been sent.
+
+ Dead time:
+ A completed frame is sent one byte per call to capture_write(), while sampling
+ continues. Each byte takes about 1ms at 9600 bps, so for the CAPTURE_SIZE
+ samples following each frame the sample rate drops to about 1kHz. These
+ samples are discarded when the frame is finished, and CAPTURE_PRE new samples
+ are stored at the full ADC rate before the trigger can fire again, so every
+ frame is sampled at one rate. A trigger condition that occurs during this
+ time is lost (edge and window triggers must re-arm before firing again).
+ Removing the dead time would need timer interrupt sampling, which would
+ disturb the bit timing of the H1 serial output functions.
+==============================================================================*/
+
+// Capture buffer sizes (CAPTURE_SIZE must be a power of 2, and is the sum of
+// the pre-trigger and post-trigger sample counts)
+#define CAPTURE_SIZE    64          // Total samples in each captured frame
+#define CAPTURE_PRE     16          // Samples kept from before the trigger
+#define CAPTURE_POST    (CAPTURE_SIZE - CAPTURE_PRE)    // Samples after trigger
+
+// Trigger mode definitions
+#define TRIG_LEVEL      0           // Trigger while sample >= trigLevel
+#define TRIG_RISING     1           // Trigger when sample rises to trigLevel
+#define TRIG_FALLING    2           // Trigger when sample falls to trigLevel
+#define TRIG_WINDOW     3           // Trigger when sample leaves the window
+                                    // from trigLevel (low) to trigHigh (high)
+
+// Capture state definitions
+#define CAPTURE_ARMED   0           // Filling history, waiting for trigger
+#define CAPTURE_POSTING 1           // Triggered, storing post-trigger samples
+#define CAPTURE_SENDING 2           // Writing the completed frame to H1
+
+// Frame sync byte written to H1 before each captured frame
+#define CAPTURE_SYNC    0xA5
+
+/**
+ * Function: void capture_config(unsigned char mode, unsigned char level,
+ *                               unsigned char high, unsigned char hyst)
+ *
+ * Set the trigger mode, trigger level, window high limit (TRIG_WINDOW only),
+ * and hysteresis, then clear the history buffer and arm the trigger.
+ * TRIG_LEVEL starts armed, while TRIG_RISING, TRIG_FALLING, and TRIG_WINDOW
+ * must first see the input in their re-arm range.
+ *
+ * Example usage: capture_config(TRIG_RISING, 128, 0, 4);
+ */
+void capture_config(unsigned char, unsigned char, unsigned char, unsigned char);
+
+/**
+ * Function: unsigned char capture_sample(unsigned char sample)
+ *
+ * Store one ADC sample in the history buffer, check the trigger condition,
+ * and return the capture state. While CAPTURE_SENDING, each sample replaces
+ * the frame byte written by the preceding capture_write() call.
+ *
+ * Example usage: capture_sample(ADC_read());
+ */
+unsigned char capture_sample(unsigned char);
+
+/**
+ * Function: void capture_write(void)
+ *
+ * Write the next byte of a completed capture frame to H1 (the sync byte is
+ * written along with the first sample). Does nothing unless the state is
+ * CAPTURE_SENDING. Call once before each call to capture_sample().
+ */
+void capture_write(void);
@@ -0,0 +1,88 @@
+/*==============================================================================
+ Library:   Delta-RLE-Decode
+ Date:      October 19, 2026
+
+ Host decoder for the UBMP4 delta-RLE sample stream. Each byte's 2-bit token
+ type selects a Run, Pair, Delta, or Literal token (see Delta-RLE.h), and each
+ decoded zig-zag delta is added to the previous sample, ignoring any carry out
+ of 8 bits, exactly as the encoder subtracted it. The decoder syncs to the
+ stream on the Literal marker byte, and stops decoding if it finds a byte that
+ is not a valid token until it syncs again on the next Literal keyframe.
+==============================================================================*/
+
+#include    "Delta-RLE.h"
+#include    "Delta-RLE-Decode.h"
+
+// Convert a zig-zag code back to an 8-bit delta: 0, 1, 2, 3... to 0, -1, +1...
+static unsigned char unzigzag(unsigned char zig)
+{
+    if(zig & 1)
+    {
+        return ((unsigned char)~(zig >> 1));
+    }
+    return (zig >> 1);
+}
+
+// Prepare the decoder for the start of a new encoded stream
+void rle_decode_reset(rle_decoder *dec)
+{
+    dec->prev = 0;
+    dec->literal = 0;
+    dec->started = 0;
+}
+
+// Decode one encoded byte and return the number of samples stored
+size_t rle_decode_byte(rle_decoder *dec, unsigned char data, unsigned char *samples)
+{
+    size_t count = 0;
+
+    // The byte following a Literal token is the raw sample value
+    if(dec->literal)
+    {
+        dec->literal = 0;
+        dec->started = 1;
+        dec->prev = data;
+        samples[0] = data;
+        return (1);
+    }
+
+    // Only the Literal marker is used to sync, since a Literal's sample byte
+    // can start with 11 too
+    if(data == RLE_LITERAL)
+    {
+        dec->literal = 1;
+        return (0);
+    }
+
+    // Deltas need a reference sample, so skip bytes until the next Literal
+    if(!dec->started)
+    {
+        return (0);
+    }
+
+    switch(data & 0xC0)
+    {
+        case RLE_RUN:
+            for(int i = (data & 0x3F) + 1; i != 0; i--)
+            {
+                samples[count++] = dec->prev;
+            }
+            break;
+        case RLE_PAIR:
+            dec->prev = (unsigned char)(dec->prev + unzigzag((data >> 3) & 0x07));
+            samples[count++] = dec->prev;
+            dec->prev = (unsigned char)(dec->prev + unzigzag(data & 0x07));
+            samples[count++] = dec->prev;
+            break;
+        case RLE_DELTA:
+            dec->prev = (unsigned char)(dec->prev + unzigzag(data & 0x3F));
+            samples[count++] = dec->prev;
+            break;
+        default:
+            // Any other 11xxxxxx byte is a sample byte read as a token, so the
+            // decoder is out of step - wait for the next Literal keyframe
+            dec->started = 0;
+            break;
+    }
+    return (count);
+}
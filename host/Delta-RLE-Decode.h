@@ -0,0 +1,39 @@
+/*==============================================================================
+ File:  Delta-RLE-Decode.h
+ Date:  October 19, 2026
+
+ Host decoder for the UBMP4 delta-RLE sample stream
+
+ Decodes the encoded byte stream written by the Delta-RLE library (see the
+ format description in Delta-RLE.h) back into 8-bit samples. The decoder
+ accepts the stream one byte at a time, so it can be fed directly from a
+ serial port as bytes arrive.
+==============================================================================*/
+
+#include    <stddef.h>
+
+// Decoder state
+typedef struct
+{
+    unsigned char prev;         // Previous decoded sample
+    int literal;                // True if the next byte is a Literal sample
+    int started;                // True once the first Literal has been decoded
+} rle_decoder;
+
+/**
+ * Function: void rle_decode_reset(rle_decoder *dec)
+ *
+ * Prepare the decoder for the start of a new encoded stream.
+ */
+void rle_decode_reset(rle_decoder *);
+
+/**
+ * Function: size_t rle_decode_byte(rle_decoder *dec, unsigned char data,
+ *                                  unsigned char *samples)
+ *
+ * Decode one encoded byte, store the decoded samples (up to 64) in samples,
+ * and return the number of samples stored. Bytes received before the decoder
+ * syncs on a Literal marker (within RLE_KEYFRAME samples of the encoder's
+ * stream) cannot be decoded and are skipped.
+ */
+size_t rle_decode_byte(rle_decoder *, unsigned char, unsigned char *);
@@ -0,0 +1,214 @@
+/*==============================================================================
+ Program:   capture-sim
+ Date:      October 19, 2026
+
+ Host simulation of the Trigger-Capture library. Simulated waveforms are fed
+ to capture_write() and capture_sample() in the same order as the CAPTURE_MODE
+ loop in Intro-5-Analog-Input.c, and the frames written to H1 are checked.
+
+ For each waveform the program reports the number of trigger events in the
+ input, the number of frames captured, the trigger latency (samples between
+ the first sample meeting the trigger condition and the frame's trigger
+ position), and the compression ratio (input samples per byte written to H1).
+ Exits with a non-zero status if any check fails.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <stdbool.h>
+
+#include    "UBMP420.h"
+#include    "Trigger-Capture.h"
+
+#define MAX_OUT     2000000     // Size of the captured H1 output buffer
+
+unsigned char out[MAX_OUT];     // Bytes written to H1
+long outCount;                  // Number of bytes written to H1
+int failures;                   // Number of failed checks
+
+// Capture H1 serial output instead of writing it to a port pin
+void H1_serial_write(unsigned char data)
+{
+    if(outCount < MAX_OUT)
+    {
+        out[outCount] = data;
+    }
+    outCount ++;
+}
+
+// Noisy baseline with a 40-sample pulse every 'period' samples
+unsigned char pulse_wave(long t, long period)
+{
+    if(t % period >= period / 2 && t % period < period / 2 + 40)
+    {
+        return (200);
+    }
+    return (60 + rand() % 5);
+}
+
+// Report and check one simulation run of a rising edge trigger at level 128
+void pulse_run(const char *name, long period, long samples, long expected)
+{
+    long events = 0;
+    long frames = 0;
+    int latency = 0;
+    unsigned char prev = 0;
+    unsigned char sample;
+
+    srand(1);
+    outCount = 0;
+    capture_config(TRIG_RISING, 128, 0, 4);
+    for(long t = 0; t < samples; t++)
+    {
+        sample = pulse_wave(t, period);
+        if(sample >= 128 && prev < 128)
+        {
+            events ++;
+        }
+        prev = sample;
+        capture_write();        // Same call order as the CAPTURE_MODE loop
+        capture_sample(sample);
+    }
+
+    // Check each frame, and find the first triggering sample in it
+    for(long i = 0; i + CAPTURE_SIZE + 1 <= outCount; i += CAPTURE_SIZE + 1)
+    {
+        int first = -1;
+
+        if(out[i] != CAPTURE_SYNC)
+        {
+            printf("  %s: missing sync byte at output byte %ld\n", name, i);
+            failures ++;
+            break;
+        }
+        frames ++;
+        for(int j = 1; j <= CAPTURE_SIZE && first < 0; j++)
+        {
+            if(out[i + j] >= 128 && out[i + j - 1] < 128)
+            {
+                first = j - 1;
+            }
+        }
+        if(first < 0 || first > CAPTURE_PRE)
+        {
+            printf("  %s: frame %ld has no trigger before its trigger position\n", name, frames);
+            failures ++;
+        }
+        else if(CAPTURE_PRE - first > latency)
+        {
+            latency = CAPTURE_PRE - first;
+        }
+    }
+
+    printf("%-22s events %6ld  frames %6ld  max latency %d  ratio %7.1f:1\n",
+           name, events, frames, latency, (double)samples / outCount);
+    if(frames != expected || latency != 0)
+    {
+        printf("  %s: expected %ld frames with zero latency\n", name, expected);
+        failures ++;
+    }
+}
+
+// Count the frames captured from a constant or repeating input
+long count_frames(unsigned char mode, unsigned char level, unsigned char high,
+                  unsigned char hyst, int wave, long samples)
+{
+    unsigned char sample;
+
+    outCount = 0;
+    capture_config(mode, level, high, hyst);
+    for(long t = 0; t < samples; t++)
+    {
+        if(wave == 0)
+        {
+            sample = 200;                   // Constant high input
+        }
+        else                                // Triangle wave, 0-255-0
+        {
+            sample = (t % 512 < 256) ? t % 256 : 255 - t % 256;
+        }
+        capture_write();
+        capture_sample(sample);
+    }
+    return (outCount / (CAPTURE_SIZE + 1));
+}
+
+// Check that frames never mix samples stored while a frame byte was written
+// (about 1ms apart) with samples stored at the full ADC rate. The sample value
+// marks how each sample was spaced from the one before it: 1 if a frame byte
+// was written in between, or 200. Only the oldest sample in a frame may follow
+// a frame byte write, since the time before it is not part of the frame.
+void phase_run(const char *name, long samples, long expected)
+{
+    unsigned char state = CAPTURE_ARMED;
+    long frames = 0;
+    long mixed = 0;
+
+    outCount = 0;
+    capture_config(TRIG_LEVEL, 128, 0, 200);    // Re-arm range unreachable, so
+    for(long t = 0; t < samples; t++)           // fire as soon as possible
+    {
+        capture_write();
+        state = capture_sample(state == CAPTURE_SENDING ? 1 : 200);
+    }
+    for(long i = 0; i + CAPTURE_SIZE + 1 <= outCount; i += CAPTURE_SIZE + 1)
+    {
+        frames ++;
+        for(int j = 2; j <= CAPTURE_SIZE; j++)
+        {
+            if(out[i + j] != 200)
+            {
+                mixed ++;
+                break;
+            }
+        }
+    }
+
+    printf("%-22s frames %6ld  (expected %ld)  mixed-rate frames %ld\n",
+           name, frames, expected, mixed);
+    if(frames != expected || mixed != 0)
+    {
+        failures ++;
+    }
+}
+
+// Check that a configuration captures the expected number of frames
+void frames_run(const char *name, long frames, long expected)
+{
+    printf("%-22s frames %6ld  (expected %ld)\n", name, frames, expected);
+    if(frames != expected)
+    {
+        failures ++;
+    }
+}
+
+int main(void)
+{
+    // Widely spaced events are all captured, closely spaced events fall in
+    // the frame write dead time (48 post-trigger + 64 frame byte + 16 new
+    // history samples)
+    pulse_run("rising, 2000 spacing", 2000, 200000, 100);
+    pulse_run("rising, 100 spacing", 100, 200000, 1000);
+
+    // Re-triggering straight after a frame waits for new full-rate history,
+    // one frame every 127 samples
+    phase_run("level, back-to-back", 20448, 161);
+
+    // Level triggers do not re-trigger on a steady input
+    frames_run("level, steady input", count_frames(TRIG_LEVEL, 128, 0, 4, 0, 2000), 1);
+
+    // Window triggers fire on both exits from the window in each period
+    frames_run("window, triangle", count_frames(TRIG_WINDOW, 60, 190, 4, 1, 51456), 200);
+
+    // Unreachable re-arm ranges keep the trigger armed instead of stalling
+    frames_run("rising, level <= hyst", count_frames(TRIG_RISING, 3, 0, 4, 1, 12800), 100);
+    frames_run("falling, level high", count_frames(TRIG_FALLING, 253, 0, 4, 1, 12800), 100);
+
+    if(failures != 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return (1);
+    }
+    printf("All capture checks passed\n");
+    return (0);
+}
@@ -0,0 +1,156 @@
+/*==============================================================================
+ Library:   flash-emulator
+ Date:      October 19, 2026
+
+ Host emulation of the PIC16F1459 flash program memory, implementing the
+ Flash-Memory.h functions. Erasing sets all bits of a 32-word row to 1, and
+ writing can only clear bits (writing an already-written word ANDs the new
+ value into it), as in the real flash memory. The upper 6 bits of each 14-bit
+ word are written as 1, the same as Flash-Memory.c.
+
+ A power cut can be scheduled during any erase or write. The interrupted
+ operation only changes a random half of the bits it would have changed, and
+ then control returns to the test through longjmp(), leaving the emulated
+ memory in the state the real flash could be left in after a power loss.
+ Accesses to the bootloader area (below 0x800) or outside program memory, and
+ misaligned row operations, stop the program.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "Flash-Memory.h"
+#include    "flash-emulator.h"
+
+unsigned int flashMemory[FLASH_WORDS];
+unsigned long flashEraseCount[FLASH_WORDS / FLASH_ROW_SIZE];
+unsigned int flashLastWord;
+unsigned long flashWordWrites;
+jmp_buf flashPowerLoss;
+
+static long cutCountdown;       // Operations until the power cut (0 = never)
+
+// Stop the program if an access is outside the writable application area
+static void check_address(unsigned int address, unsigned int align)
+{
+    if(address < 0x800 || address >= FLASH_WORDS || (address % align) != 0)
+    {
+        fprintf(stderr, "flash-emulator: bad flash address 0x%04X\n", address);
+        abort();
+    }
+}
+
+// Return true if this operation is the one interrupted by the power cut
+static int power_cut_now(void)
+{
+    if(cutCountdown == 0)
+    {
+        return (0);
+    }
+    cutCountdown --;
+    return (cutCountdown == 0);
+}
+
+// Return a random mask with about half of its 14 bits set
+static unsigned int random_bits(void)
+{
+    return ((unsigned int)rand() & FLASH_ERASED);
+}
+
+// Program one word, clearing only some of its bits if interrupted
+static void program_word(unsigned int address, unsigned char data, int cut)
+{
+    unsigned int clear = ~(0x3F00u | data) & FLASH_ERASED;    // Bits to clear
+
+    if(cut)
+    {
+        clear = clear & random_bits();
+    }
+    flashMemory[address] = flashMemory[address] & ~clear;
+}
+
+// Erase the whole emulated memory, clear counters, and cancel any power cut
+void flash_emulator_reset(void)
+{
+    for(unsigned int i = 0; i < FLASH_WORDS; i++)
+    {
+        flashMemory[i] = FLASH_ERASED;
+    }
+    for(unsigned int i = 0; i < FLASH_WORDS / FLASH_ROW_SIZE; i++)
+    {
+        flashEraseCount[i] = 0;
+    }
+    flashLastWord = 0;
+    flashWordWrites = 0;
+    cutCountdown = 0;
+}
+
+// Cut the power during the given number of following erase or write operations
+void flash_emulator_cut(long operations)
+{
+    cutCountdown = operations;
+}
+
+// Read the low byte of the flash program memory word at address
+unsigned char flash_read(unsigned int address)
+{
+    if(address >= FLASH_WORDS)
+    {
+        fprintf(stderr, "flash-emulator: bad flash address 0x%04X\n", address);
+        abort();
+    }
+    return ((unsigned char)flashMemory[address]);
+}
+
+// Erase the flash row starting at address
+void flash_erase_row(unsigned int address)
+{
+    int cut = power_cut_now();
+
+    check_address(address, FLASH_ROW_SIZE);
+    flashEraseCount[address / FLASH_ROW_SIZE] ++;
+    for(unsigned int i = 0; i < FLASH_ROW_SIZE; i++)
+    {
+        flashMemory[address + i] |= cut ? random_bits() : FLASH_ERASED;
+    }
+    if(cut)
+    {
+        longjmp(flashPowerLoss, 1);
+    }
+}
+
+// Write FLASH_ROW_SIZE bytes of data into the low bytes of the row at address
+void flash_write_row(unsigned int address, unsigned char *data)
+{
+    int cut = power_cut_now();
+
+    check_address(address, FLASH_ROW_SIZE);
+    for(unsigned int i = 0; i < FLASH_ROW_SIZE; i++)
+    {
+        program_word(address + i, data[i], cut);
+    }
+    if(cut)
+    {
+        longjmp(flashPowerLoss, 1);
+    }
+}
+
+// Write data into the low byte of the single flash word at address
+void flash_write_word(unsigned int address, unsigned char data)
+{
+    int cut = power_cut_now();
+
+    check_address(address, 1);
+    program_word(address, data, cut);
+
+    // Count the write if the word was written, even if interrupted
+    if((unsigned char)flashMemory[address] == data)
+    {
+        flashLastWord = address;
+        flashWordWrites ++;
+    }
+    if(cut)
+    {
+        longjmp(flashPowerLoss, 1);
+    }
+}
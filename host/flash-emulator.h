@@ -0,0 +1,39 @@
+/*==============================================================================
+ File:  flash-emulator.h
+ Date:  October 19, 2026
+
+ Host emulation of the PIC16F1459 flash program memory
+
+ Variables and functions for controlling the emulated flash memory that
+ replaces Flash-Memory.c in host builds. Include Flash-Memory.h first.
+==============================================================================*/
+
+#include    <setjmp.h>
+
+#define FLASH_WORDS     0x2000      // 8K words of program memory
+#define FLASH_ERASED    0x3FFF      // Value of an erased 14-bit word
+
+extern unsigned int flashMemory[FLASH_WORDS];       // Emulated memory contents
+extern unsigned long flashEraseCount[FLASH_WORDS / FLASH_ROW_SIZE];
+extern unsigned int flashLastWord;  // Address of the last flash_write_word()
+extern unsigned long flashWordWrites;   // flash_write_word() calls that wrote
+                                        // their data (even if interrupted)
+extern jmp_buf flashPowerLoss;      // Jump target for a simulated power loss
+
+/**
+ * Function: void flash_emulator_reset(void)
+ *
+ * Erase the whole emulated memory, clear the counters, and cancel any power
+ * cut.
+ */
+void flash_emulator_reset(void);
+
+/**
+ * Function: void flash_emulator_cut(long operations)
+ *
+ * Cut the power part way through the given number of following erase or
+ * write operations (1 for the next one), or never if operations is 0. The
+ * interrupted operation leaves a random subset of its bits changed, and then
+ * calls longjmp(flashPowerLoss, 1).
+ */
+void flash_emulator_cut(long);
@@ -0,0 +1,8 @@
+/*==============================================================================
+ File:  xc.h
+ Date:  October 19, 2026
+
+ Host build stand-in for the Microchip XC8 compiler include file. The UBMP4
+ libraries built by the host Makefile include xc.h but do not access any
+ PIC16F1459 registers, so nothing needs to be defined here.
+==============================================================================*/
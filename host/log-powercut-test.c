@@ -0,0 +1,231 @@
+/*==============================================================================
+ Program:   log-powercut-test
+ Date:      October 19, 2026
+
+ Power loss test of the Flash-Log library using the emulated flash memory.
+
+ Usage:     log-powercut-test [cuts]
+
+ Repeatedly starts the logger (as after a reset), logs consecutive sample
+ values (each repeated for the LOG_INTERVAL samples it stands for), and cuts
+ the power part way through a random flash erase or write.
+ After each power cut the logger is started again and the log is dumped, and
+ the dump must:
+
+ - start with LOG_SYNC and a count that matches the number of samples sent,
+ - contain only complete records of consecutive sample values,
+ - end with the last sample of the newest committed record, and
+ - contain every committed record that is still in flash (all but the row
+   being replaced when the power was cut).
+
+ A final run without a power cut checks that samples still in RAM are dumped,
+ and that the log rows are erased only once per LOG_ROW_DATA logged samples
+ (and LOG_INTERVAL * LOG_ROW_DATA samples given to log_sample()). The erase
+ counts of the log rows are also checked for even wear. Exits with a non-zero
+ status if any check fails.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <stdbool.h>
+
+#include    "Flash-Memory.h"
+#include    "Flash-Log.h"
+#include    "flash-emulator.h"
+
+#define MAX_OUT     1024        // Size of the captured H1 output buffer
+
+unsigned char out[MAX_OUT];     // Bytes written to H1
+int outCount;                   // Number of bytes written to H1
+int failures;                   // Number of failed checks
+
+// Logging state kept outside main() so that it survives the longjmp() back
+// from a power cut
+long commits;                   // Records committed since the flash was erased
+unsigned char value;            // Next sample value to log
+unsigned char last;             // Last sample of the newest committed record
+unsigned long writes;           // Commit writes before the current sample
+unsigned long calls;            // Samples given to log_sample()
+
+// Count a record committed by the last flash_write_word() call
+void check_commit(void)
+{
+    if(flashWordWrites != writes)
+    {
+        commits ++;
+        last = flash_read(flashLastWord - 2);
+    }
+}
+
+// Capture H1 serial output instead of writing it to a port pin
+void H1_serial_write(unsigned char data)
+{
+    if(outCount < MAX_OUT)
+    {
+        out[outCount] = data;
+    }
+    outCount ++;
+}
+
+// Log one sample value, repeated for the whole logging interval
+void log_value(unsigned char sample)
+{
+    for(unsigned int i = LOG_INTERVAL; i != 0; i--)
+    {
+        log_sample(sample);
+        calls ++;
+    }
+}
+
+// Return the total number of log row erases
+unsigned long log_erases(void)
+{
+    unsigned long erases = 0;
+
+    for(unsigned int row = 0; row < LOG_ROWS; row++)
+    {
+        erases += flashEraseCount[(LOG_START / FLASH_ROW_SIZE) + row];
+    }
+    return (erases);
+}
+
+// Report a failed check
+void fail(long cut, const char *message)
+{
+    if(failures < 20)
+    {
+        printf("  cut %ld: %s\n", cut, message);
+    }
+    failures ++;
+}
+
+// Dump the log and check it, returning the number of samples it contains
+int check_dump(long cut, bool haveNewest, unsigned char newest)
+{
+    int count;
+
+    outCount = 0;
+    log_dump();
+    count = out[1];
+    if(outCount < 2 || out[0] != LOG_SYNC || count != outCount - 2)
+    {
+        fail(cut, "bad dump header or sample count");
+        return (0);
+    }
+    for(int i = 3; i < outCount; i++)
+    {
+        if(out[i] != (unsigned char)(out[i - 1] + 1))
+        {
+            fail(cut, "dumped samples are not consecutive");
+            return (count);
+        }
+    }
+    if(haveNewest && (count == 0 || out[outCount - 1] != newest))
+    {
+        fail(cut, "newest sample missing from dump");
+    }
+    return (count);
+}
+
+int main(int argc, char *argv[])
+{
+    long cuts = (argc > 1) ? atol(argv[1]) : 20000;
+    unsigned long minErase = ~0UL;
+    unsigned long maxErase = 0;
+    unsigned long erases;
+    long logged = LOG_ROWS * LOG_ROW_DATA * 10;
+    int count;
+
+    srand(1);
+    flash_emulator_reset();
+
+    for(long cut = 1; cut <= cuts; cut++)
+    {
+        // Start the logger and log samples until the power is cut, part way
+        // through one of the next few erase, write, or commit operations
+        flash_emulator_cut(1 + rand() % (LOG_ROWS * 3 * 2));
+        if(setjmp(flashPowerLoss) == 0)
+        {
+            log_config();
+            while(1)
+            {
+                writes = flashWordWrites;
+                log_value(value);
+                value ++;
+                log_update();
+                check_commit();
+            }
+        }
+        check_commit();         // The interrupted write may have completed
+
+        // Restart after the power loss and check the dumped log
+        flash_emulator_cut(0);
+        log_config();
+        count = check_dump(cut, commits != 0, last);
+        if(count % LOG_ROW_DATA != 0)
+        {
+            fail(cut, "dump contains a partial record");
+        }
+        if(count < ((commits < LOG_ROWS - 1) ? commits : LOG_ROWS - 1) * LOG_ROW_DATA)
+        {
+            fail(cut, "committed records missing from dump");
+        }
+
+        // Samples in RAM were lost, so continue after the last logged sample
+        value = last + 1;
+    }
+
+    // Check that samples not yet written to flash are also dumped, and that
+    // rows are only erased once they are full of logged samples
+    flash_emulator_cut(0);
+    log_config();
+    erases = log_erases();
+    calls = 0;
+    for(long i = 0; i < logged; i++)
+    {
+        log_value(value);
+        last = value;
+        value ++;
+        if(i % 3 == 0)
+        {
+            log_update();
+        }
+    }
+    count = check_dump(cuts + 1, true, last);
+    erases = log_erases() - erases;
+    printf("%ld samples logged from %lu: %lu row erases, 1 per %.1f logged samples\n",
+           logged, calls, erases, (double)logged / erases);
+    if(erases * LOG_ROW_DATA > (unsigned long)logged ||
+       erases * LOG_ROW_DATA * LOG_INTERVAL > calls)
+    {
+        fail(cuts + 1, "log rows erased more than once per full record");
+    }
+    if(erases < (unsigned long)logged / LOG_ROW_DATA - 1)
+    {
+        fail(cuts + 1, "full records not written to flash");
+    }
+
+    for(unsigned int row = 0; row < LOG_ROWS; row++)
+    {
+        unsigned long erases = flashEraseCount[(LOG_START / FLASH_ROW_SIZE) + row];
+
+        minErase = (erases < minErase) ? erases : minErase;
+        maxErase = (erases > maxErase) ? erases : maxErase;
+    }
+
+    printf("%ld power cuts, %ld records committed, final dump %d samples\n",
+           cuts, commits, count);
+    printf("log row erases: min %lu, max %lu\n", minErase, maxErase);
+    if(maxErase > minErase + minErase / 10)
+    {
+        fail(cuts + 1, "log rows are not evenly worn");
+    }
+
+    if(failures != 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return (1);
+    }
+    printf("All flash log checks passed\n");
+    return (0);
+}
@@ -0,0 +1,221 @@
+/*==============================================================================
+ Program:   rle-bench
+ Date:      October 19, 2026
+
+ Benchmark and round-trip test of the Delta-RLE encoder and host decoder.
+
+ Usage:     rle-bench [trace-file...]
+
+ Encodes a set of synthetic 1M-sample traces, plus any recorded traces given
+ on the command line (raw 8-bit samples, one per byte, e.g. captured from H1
+ by writing rawADC with H1_serial_write()), then decodes each encoded stream
+ and checks that it matches the original trace. Each stream is also decoded
+ starting part way through (as by a receiver connected to H1 after start-up)
+ and with one byte lost, and the decoder must be back in step within two
+ keyframes. For each trace it reports the compression ratio (samples per
+ encoded byte), the most encoded bytes produced by a single sample, the most
+ consecutive samples held without any encoded output, and the host encoder
+ time per sample. Exits with a non-zero status if any trace fails to
+ round-trip or resync, or if samples are held for RLE_RUN_MAX samples or more.
+
+ The host time shows relative encoder cost only. PIC16F1459 cycles per sample
+ must be measured with the MPLAB X simulator stopwatch on an XC8 build.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <stdbool.h>
+#include    <math.h>
+#include    <time.h>
+
+#include    "Delta-RLE.h"
+#include    "Delta-RLE-Decode.h"
+
+#define TRACE_SIZE  1000000     // Samples in each synthetic trace
+
+unsigned char trace[TRACE_SIZE];        // Trace being benchmarked
+unsigned char encoded[TRACE_SIZE * 3];  // Encoded stream (3 bytes max/sample)
+unsigned char decoded[TRACE_SIZE + 1024];   // Decoded samples
+int failures;                           // Number of failed round-trips
+
+// Decode the encoded stream from byte 'from', leaving out byte 'lost', and
+// return true if all samples from two keyframes after sample 'join' (the
+// sample being encoded at byte 'from' or 'lost') decode correctly
+bool resync(const unsigned char *samples, size_t n, size_t bytes,
+            size_t from, size_t lost, size_t join)
+{
+    size_t decodedCount = 0;
+    size_t check = n - join - 2 * RLE_KEYFRAME;
+    rle_decoder dec;
+
+    rle_decode_reset(&dec);
+    for(size_t i = from; i < bytes && decodedCount <= n + 512; i++)
+    {
+        if(i != lost)
+        {
+            decodedCount += rle_decode_byte(&dec, encoded[i], &decoded[decodedCount]);
+        }
+    }
+    if(decodedCount < check || decodedCount > n + 512)
+    {
+        return (false);
+    }
+
+    // The decoded samples must end with the same samples as the trace
+    for(size_t i = 1; i <= check; i++)
+    {
+        if(decoded[decodedCount - i] != samples[n - i])
+        {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+// Encode, decode, and report one trace
+void bench(const char *name, const unsigned char *samples, size_t n)
+{
+    size_t bytes = 0;
+    size_t count;
+    size_t most = 0;
+    size_t decodedCount = 0;
+    size_t middle = 0;
+    size_t quiet = 0;
+    size_t held = 0;
+    bool synced;
+    clock_t start;
+    double seconds;
+    rle_decoder dec;
+
+    // Encode the trace the same way as the STREAM_MODE loop
+    start = clock();
+    encode_reset();
+    for(size_t i = 0; i < n; i++)
+    {
+        if(i == n / 2)
+        {
+            middle = bytes;     // First byte encoded from the middle sample
+        }
+        count = encode_sample(samples[i]);
+        for(size_t j = 0; j < count; j++)
+        {
+            encoded[bytes++] = encOut[j];
+        }
+        if(count > most)
+        {
+            most = count;
+        }
+        quiet = (count == 0) ? quiet + 1 : 0;
+        if(quiet > held)
+        {
+            held = quiet;
+        }
+    }
+    count = encode_flush();
+    for(size_t j = 0; j < count; j++)
+    {
+        encoded[bytes++] = encOut[j];
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Decode the stream and compare it with the original trace
+    rle_decode_reset(&dec);
+    for(size_t i = 0; i < bytes && decodedCount <= n; i++)
+    {
+        decodedCount += rle_decode_byte(&dec, encoded[i], &decoded[decodedCount]);
+    }
+    for(size_t i = 0; i < n && decodedCount == n; i++)
+    {
+        if(decoded[i] != samples[i])
+        {
+            decodedCount = 0;
+        }
+    }
+
+    // Decode from the third byte, from part way through the middle sample's
+    // bytes, and with the byte after the middle sample's first byte lost
+    synced = n < 4 * RLE_KEYFRAME ||
+             (resync(samples, n, bytes, 2, bytes, 0) &&
+              resync(samples, n, bytes, middle + 1, bytes, n / 2) &&
+              resync(samples, n, bytes, 0, middle + 1, n / 2));
+
+    printf("%-14s samples %8zu  bytes %8zu  ratio %6.2f:1  max bytes/sample %zu  max held %2zu  %5.1f ns/sample  %s, %s\n",
+           name, n, bytes, (double)n / bytes, most, held, seconds * 1e9 / n,
+           decodedCount == n ? "round-trip ok" : "ROUND-TRIP FAILED",
+           synced ? "resync ok" : "RESYNC FAILED");
+    if(held >= RLE_RUN_MAX)
+    {
+        printf("  %s: samples held for longer than RLE_RUN_MAX\n", name);
+        failures ++;
+    }
+    if(decodedCount != n || !synced)
+    {
+        failures ++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n;
+
+    // Slow temperature-like drift with occasional one-count noise
+    srand(1);
+    for(long i = 0; i < TRACE_SIZE; i++)
+    {
+        trace[i] = 100 + (int)(3 * sin(i / 5000.0)) + ((rand() % 20) == 0);
+    }
+    bench("temperature", trace, TRACE_SIZE);
+
+    // Noisy full-scale sine wave
+    for(long i = 0; i < TRACE_SIZE; i++)
+    {
+        trace[i] = 128 + (int)(100 * sin(i / 50.0)) + (rand() % 3 - 1);
+    }
+    bench("sine", trace, TRACE_SIZE);
+
+    // Slow ramp, one count every 16 samples
+    for(long i = 0; i < TRACE_SIZE; i++)
+    {
+        trace[i] = (unsigned char)(i / 16);
+    }
+    bench("ramp", trace, TRACE_SIZE);
+
+    // Square wave with large steps
+    for(long i = 0; i < TRACE_SIZE; i++)
+    {
+        trace[i] = (i / 1000) % 2 ? 200 : 30;
+    }
+    bench("square", trace, TRACE_SIZE);
+
+    // Random noise (worst case)
+    for(long i = 0; i < TRACE_SIZE; i++)
+    {
+        trace[i] = (unsigned char)rand();
+    }
+    bench("random", trace, TRACE_SIZE);
+
+    // Recorded traces
+    for(int arg = 1; arg < argc; arg++)
+    {
+        FILE *in = fopen(argv[arg], "rb");
+
+        if(in == NULL)
+        {
+            perror(argv[arg]);
+            return (1);
+        }
+        n = fread(trace, 1, TRACE_SIZE, in);
+        fclose(in);
+        if(n != 0)
+        {
+            bench(argv[arg], trace, n);
+        }
+    }
+
+    if(failures != 0)
+    {
+        printf("%d trace(s) failed to round-trip or resync\n", failures);
+        return (1);
+    }
+    return (0);
+}
@@ -0,0 +1,65 @@
+/*==============================================================================
+ Program:   rle-decode
+ Date:      October 19, 2026
+
+ Decode a delta-RLE encoded sample stream captured from H1 (STREAM_MODE) and
+ print the decoded samples, one decimal value per line.
+
+ Usage:     rle-decode [-r] [file]
+
+ Reads the encoded stream from file, or from standard input if no file is
+ given (e.g. a serial port device). Decoding starts at the first Literal
+ keyframe in the stream, so the capture can be started at any time. The -r
+ option writes the decoded samples as raw bytes instead of decimal text.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <string.h>
+
+#include    "Delta-RLE-Decode.h"
+
+int main(int argc, char *argv[])
+{
+    FILE *in = stdin;
+    int raw = 0;
+    int c;
+    size_t count;
+    unsigned char samples[64];
+    rle_decoder dec;
+
+    if(argc > 1 && strcmp(argv[1], "-r") == 0)
+    {
+        raw = 1;
+        argc --;
+        argv ++;
+    }
+    if(argc > 2)
+    {
+        fprintf(stderr, "usage: rle-decode [-r] [file]\n");
+        return (2);
+    }
+    if(argc == 2 && (in = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return (1);
+    }
+
+    rle_decode_reset(&dec);
+    while((c = fgetc(in)) != EOF)
+    {
+        count = rle_decode_byte(&dec, (unsigned char)c, samples);
+        for(size_t i = 0; i < count; i++)
+        {
+            if(raw)
+            {
+                putchar(samples[i]);
+            }
+            else
+            {
+                printf("%u\n", samples[i]);
+            }
+        }
+        fflush(stdout);         // Show samples as soon as they are decoded
+    }
+    return (0);
+}